@@ -0,0 +1,247 @@
+/*
+Detective Quest - Benchmark das chaves de pista
+Compara hash, igualdade e ordenação byte a byte (strcmp / hashEscalar) com as versões
+vetorizadas de detetiveQuest_final.c (ChavePista), em pistas com tamanhos realistas.
+As linhas de fluxo completo comparam com o código original (referencia_original.c: char[100] + strcmp),
+já incluindo o preparo da chave que as funções que recebem char* fazem a cada chamada.
+
+Compilação (o kernel é escolhido pelas flags do compilador):
+  gcc -O2          benchmark_pistas.c -o benchmark_pistas   (SSE2: só comparação; hash escalar)
+  gcc -O2 -mavx2   benchmark_pistas.c -o benchmark_pistas   (AVX2)
+  gcc -O2 -mno-sse2 benchmark_pistas.c -o benchmark_pistas  (escalar)
+*/
+
+#define DQ_SEM_MAIN
+#include "detetiveQuest_final.c"
+#include "referencia_original.c"
+
+#include <time.h>
+
+#define NUM_PISTAS 4096
+#define REPETICOES 400
+
+// Vocabulário no estilo das pistas do jogo: frases de 2 a 7 palavras (~10 a 60 bytes),
+// muitas começando pelas mesmas palavras, como "Pegadas de lama" / "Pegadas recentes ...".
+static const char* INICIOS[] = {
+    "Pegadas", "Livro", "Chave", "Gaveta", "Panela", "Lençol", "Carta", "Luva",
+    "Copo", "Bilhete", "Mancha", "Janela", "Fio", "Botão", "Frasco", "Retrato"
+};
+static const char* PALAVRAS[] = {
+    "de", "com", "perto", "do", "da", "sob", "o", "a", "lama", "sangue", "portão",
+    "tapete", "página", "faltando", "arrombada", "odor", "estranho", "manchado",
+    "recentes", "quebrado", "rasgada", "escondida", "molhado", "aberta", "cinzas",
+    "jardim", "biblioteca", "cozinha", "escritório", "quarto", "porão", "lareira"
+};
+#define NUM_INICIOS  ((int) (sizeof(INICIOS)  / sizeof(INICIOS[0])))
+#define NUM_PALAVRAS ((int) (sizeof(PALAVRAS) / sizeof(PALAVRAS[0])))
+
+static const char* PISTAS_DO_JOGO[] = {
+    "Pegadas de lama", "Lençol manchado", "Livro com página faltando",
+    "Panela com odor estranho", "Pegadas recentes perto do portão",
+    "Gaveta arrombada", "Chave perdida sob o tapete"
+};
+#define NUM_PISTAS_JOGO ((int) (sizeof(PISTAS_DO_JOGO) / sizeof(PISTAS_DO_JOGO[0])))
+
+
+// Gerador simples e reprodutível (xorshift32)
+static unsigned int semente = 2463534242u;
+static unsigned int aleatorio(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+// Gera uma pista: 1 em 8 é uma pista real do jogo, o resto é frase sorteada
+static void gerarPista(char* destino, size_t cap) {
+    if (aleatorio() % 8 == 0) {
+        snprintf(destino, cap, "%s", PISTAS_DO_JOGO[aleatorio() % NUM_PISTAS_JOGO]);
+        return;
+    }
+    size_t usado = (size_t) snprintf(destino, cap, "%s", INICIOS[aleatorio() % NUM_INICIOS]);
+    int palavras = 1 + (int) (aleatorio() % 6);
+    for (int i = 0; i < palavras && usado < cap; i++) {
+        usado += (size_t) snprintf(destino + usado, cap - usado, " %s", PALAVRAS[aleatorio() % NUM_PALAVRAS]);
+    }
+}
+
+static double segundosDesde(clock_t inicio) {
+    return (double) (clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+static void relatar(const char* nome, double tEscalar, double tChave, long ops) {
+    printf("%-24s  original: %7.2f ns/op   ChavePista: %7.2f ns/op   (%.2fx)\n",
+           nome, 1e9 * tEscalar / ops, 1e9 * tChave / ops,
+           tChave > 0 ? tEscalar / tChave : 0.0);
+}
+
+int main(void) {
+    static char textos[NUM_PISTAS][TAM_CHAVE];
+    static ChavePista chaves[NUM_PISTAS];
+    static int pares[NUM_PISTAS];
+    volatile unsigned int sumidouro = 0;
+    size_t somaTam = 0;
+
+    for (int i = 0; i < NUM_PISTAS; i++) {
+        gerarPista(textos[i], TAM_CHAVE);
+        criarChave(&chaves[i], textos[i]);
+        somaTam += chaves[i].tam;
+    }
+    // Metade dos pares compara a pista com uma cópia igual, metade com outra pista sorteada
+    for (int i = 0; i < NUM_PISTAS; i++) {
+        pares[i] = (aleatorio() % 2) ? i : (int) (aleatorio() % NUM_PISTAS);
+    }
+    static ChavePista copias[NUM_PISTAS];
+    static char textosCopia[NUM_PISTAS][TAM_CHAVE];
+    for (int i = 0; i < NUM_PISTAS; i++) {
+        memcpy(textosCopia[i], textos[pares[i]], TAM_CHAVE);
+        copias[i] = chaves[pares[i]];
+    }
+
+#if defined(__AVX2__)
+    const char* kernel = "AVX2";
+#elif defined(__SSE2__)
+    const char* kernel = "SSE2";
+#else
+    const char* kernel = "escalar";
+#endif
+    printf("=== Benchmark de chaves de pista (kernel: %s) ===\n", kernel);
+    printf("%d pistas, tamanho médio %.1f bytes, %d repetições\n\n",
+           NUM_PISTAS, (double) somaTam / NUM_PISTAS, REPETICOES);
+
+    long ops = (long) NUM_PISTAS * REPETICOES;
+    clock_t t;
+    double tEscalar, tChave;
+
+    // Hash a partir do char*: inclui criarChave (cópia, zeros do bloco e prefixo)
+    ChavePista temporaria;
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++) sumidouro += hashEscalar(textos[i]);
+    tEscalar = segundosDesde(t);
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++) {
+            criarChave(&temporaria, textos[i]);
+            sumidouro += temporaria.hash;
+        }
+    tChave = segundosDesde(t);
+    relatar("hash (com criarChave)", tEscalar, tChave, ops);
+
+    // Só o kernel de hash, com a chave já montada
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++) sumidouro += hashTexto(chaves[i].texto, chaves[i].tam);
+    tChave = segundosDesde(t);
+    relatar("hash (kernel)", tEscalar, tChave, ops);
+
+    // Igualdade (busca na tabela hash)
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++) sumidouro += (strcmp(textos[i], textosCopia[i]) == 0);
+    tEscalar = segundosDesde(t);
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++) sumidouro += (unsigned int) chavesIguais(&chaves[i], &copias[i]);
+    tChave = segundosDesde(t);
+    relatar("igualdade", tEscalar, tChave, ops);
+
+    // Ordenação (descida na BST): pista i contra a vizinha
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++)
+            sumidouro += (strcmp(textos[i], textos[(i + r + 1) % NUM_PISTAS]) < 0);
+    tEscalar = segundosDesde(t);
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++)
+            sumidouro += (compararChaves(&chaves[i], &chaves[(i + r + 1) % NUM_PISTAS]) < 0);
+    tChave = segundosDesde(t);
+    relatar("ordem", tEscalar, tChave, ops);
+
+    // Fluxo completo do jogo: mesmas pistas e associações nas duas implementações
+    HashSuspeitos hash;
+    RefHashSuspeitos refHash;
+    initHash(&hash);
+    for (int i = 0; i < TAM_HASH; i++) refHash.buckets[i] = NULL;
+    for (int i = 0; i < NUM_PISTAS; i += 2) {
+        const char* suspeito = (i % 3) ? "Jardineiro" : "Camareira";
+        inserirNaHash(&hash, textos[i], suspeito);
+        refInserirNaHash(&refHash, textos[i], suspeito);
+    }
+
+    // inserirPista: monta a BST inteira várias vezes
+    const int montagens = REPETICOES / 20;
+    long opsInsercao = (long) NUM_PISTAS * montagens;
+    RefPistaNode* refPistas = NULL;
+    PistaNode* pistas = NULL;
+    tEscalar = tChave = 0.0;
+    for (int r = 0; r < montagens; r++) {
+        refLiberarPistas(refPistas);
+        liberarArvorePistas(pistas);
+        refPistas = NULL;
+        pistas = NULL;
+        t = clock();
+        for (int i = 0; i < NUM_PISTAS; i++) refPistas = refInserirPista(refPistas, textos[i]);
+        tEscalar += segundosDesde(t);
+        t = clock();
+        for (int i = 0; i < NUM_PISTAS; i++) pistas = inserirPista(pistas, textos[i]);
+        tChave += segundosDesde(t);
+    }
+    relatar("inserirPista", tEscalar, tChave, opsInsercao);
+
+    // encontrarSuspeito(char*): metade das pistas está na hash, metade não
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++) sumidouro += (refEncontrarSuspeito(&refHash, textos[i]) != NULL);
+    tEscalar = segundosDesde(t);
+    t = clock();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < NUM_PISTAS; i++) sumidouro += (encontrarSuspeito(&hash, textos[i]) != NULL);
+    tChave = segundosDesde(t);
+    relatar("encontrarSuspeito", tEscalar, tChave, ops);
+
+    // encontrarSuspeito com a tabela do jogo (7 pistas): aqui pesa o preparo da chave
+    HashSuspeitos hashJogo;
+    RefHashSuspeitos refHashJogo;
+    initHash(&hashJogo);
+    for (int i = 0; i < TAM_HASH; i++) refHashJogo.buckets[i] = NULL;
+    for (int i = 0; i < NUM_PISTAS_JOGO; i++) {
+        inserirNaHash(&hashJogo, PISTAS_DO_JOGO[i], "Jardineiro");
+        refInserirNaHash(&refHashJogo, PISTAS_DO_JOGO[i], "Jardineiro");
+    }
+    long opsJogo = (long) NUM_PISTAS_JOGO * REPETICOES * 100;
+    t = clock();
+    for (int r = 0; r < REPETICOES * 100; r++)
+        for (int i = 0; i < NUM_PISTAS_JOGO; i++) sumidouro += (refEncontrarSuspeito(&refHashJogo, PISTAS_DO_JOGO[i]) != NULL);
+    tEscalar = segundosDesde(t);
+    t = clock();
+    for (int r = 0; r < REPETICOES * 100; r++)
+        for (int i = 0; i < NUM_PISTAS_JOGO; i++) sumidouro += (encontrarSuspeito(&hashJogo, PISTAS_DO_JOGO[i]) != NULL);
+    tChave = segundosDesde(t);
+    relatar("encontrarSuspeito (jogo)", tEscalar, tChave, opsJogo);
+    refLiberarHash(&refHashJogo);
+    liberarHash(&hashJogo);
+
+    // Veredito: percorre a BST e busca cada pista na hash
+    const int julgamentos = REPETICOES / 40;
+    long opsVeredito = (long) NUM_PISTAS * julgamentos;
+    int contRef = 0, cont = 0;
+    t = clock();
+    for (int r = 0; r < julgamentos; r++) refContarPistasDoSuspeito(refPistas, &refHash, "Jardineiro", &contRef);
+    tEscalar = segundosDesde(t);
+    ChavePista acusado;
+    criarChave(&acusado, "Jardineiro");
+    t = clock();
+    for (int r = 0; r < julgamentos; r++) contarPistasDoSuspeito(pistas, &hash, &acusado, &cont);
+    tChave = segundosDesde(t);
+    relatar("contarPistasDoSuspeito", tEscalar, tChave, opsVeredito);
+
+    printf("\n(verificação: %u / %d / %d)\n", (unsigned int) sumidouro, contRef, cont);
+
+    refLiberarPistas(refPistas);
+    liberarArvorePistas(pistas);
+    refLiberarHash(&refHash);
+    liberarHash(&hash);
+    return 0;
+}
@@ -1,15 +1,43 @@
 /*
 Detective Quest - Nível Aventureiro/Mestre
-Mapa da mansão (Árvore Binária) + Coleta de Pistas (BST) + Tabela Hash de Suspeitos
+Mapa da mansão (Árvore Binária carregada em Grafo) + Coleta de Pistas (BST) + Tabela Hash de Suspeitos
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 
 // Estruturas de dados
 
+// Chave de texto (pista ou suspeito) em espaço fixo e alinhado.
+// Tamanho, hash e os 4 primeiros bytes ficam pré-calculados, então a maioria das
+// comparações termina sem ler o texto; quando precisa ler, compara blocos de 16/32 bytes.
+#define TAM_CHAVE 128
+
+// Bloco lido pelos kernels: depois do texto, a chave tem zeros até o fim do bloco
+// que contém o '\0' (no mínimo 4 bytes, que formam o prefixo). O resto não é lido.
+#if defined(__AVX2__)
+#define BLOCO_CHAVE 32
+#elif defined(__SSE2__)
+#define BLOCO_CHAVE 16
+#else
+#define BLOCO_CHAVE 4
+#endif
+
+typedef struct {
+    _Alignas(16) char texto[TAM_CHAVE]; // texto + zeros até o fim do bloco (BLOCO_CHAVE)
+    unsigned int hash;    // hash completo (antes do % TAM_HASH)
+    unsigned int prefixo; // 4 primeiros bytes em big-endian (ordena como strcmp)
+    unsigned int tam;     // strlen(texto), no máximo TAM_CHAVE - 1
+} ChavePista;
+
 // Nó da árvore da mansão (mapa)
 typedef struct Sala {
     char nome[50]; // Nome do cômodo
@@ -20,7 +48,7 @@ typedef struct Sala {
 
 // Nó da BST de pistas coletadas
 typedef struct PistaNode {
-    char valor[100]; // Conteúdo da pista
+    ChavePista valor; // Conteúdo da pista
     struct PistaNode* esquerda; // Subárvore esquerda
     struct PistaNode* direita;  // Subárvore direita
 } PistaNode;
@@ -29,8 +57,8 @@ typedef struct PistaNode {
 #define TAM_HASH 101
 
 typedef struct HashNode {
-    char chave[100];   // pista
-    char valor[50];    // suspeito
+    ChavePista chave;  // pista
+    ChavePista valor;  // suspeito
     struct HashNode* prox;
 } HashNode;
 
@@ -38,6 +66,167 @@ typedef struct {
     HashNode* buckets[TAM_HASH];
 } HashSuspeitos;
 
+// Mapa da mansão como grafo (lista de adjacência compacta, formato CSR)
+// Permite cômodos com qualquer número de saídas, corredores compartilhados e ciclos.
+// As saídas da sala i ficam em destinos[inicio[i] .. inicio[i+1]-1].
+#define SEM_PISTA ((size_t) -1)
+#define SEM_LADO  (-1)
+
+typedef struct {
+    int numSalas;
+    int capSalas;
+    size_t* nomeOff;   // deslocamento do nome em 'textos'
+    size_t* pistaOff;  // deslocamento da pista em 'textos' (SEM_PISTA se não houver)
+    signed char* saidaEsquerda; // qual saída da sala veio de 'esquerda' (SEM_LADO se nenhuma)
+    signed char* saidaDireita;  // qual saída da sala veio de 'direita'  (SEM_LADO se nenhuma)
+
+    char* textos;      // área única com todos os nomes e pistas
+    size_t usoTextos;
+    size_t capTextos;
+
+    int numConexoes;
+    int capConexoes;
+    int* origens;      // conexões pendentes (liberado em finalizarMapa)
+    int* destinos;     // destinos das conexões (ordenados por origem após finalizarMapa)
+    int* inicio;       // numSalas + 1 posições (NULL até finalizarMapa)
+} MapaGrafo;
+
+
+// Chaves de pista: hash, igualdade e ordenação vetorizadas
+
+// Pesos do hash: POT131[j] = 131^(127 - j) (mod 2^32), com zeros no fim.
+// Para um texto de tamanho n, o byte i tem peso 131^(n-1-i) = POT131[128 - n + i],
+// então os pesos de cada bloco são lidos em sequência a partir de POT131 + 128 - n.
+static const unsigned int POT131[TAM_CHAVE + 16] = {
+    0xE1890C2Bu, 0xD2D22539u, 0xA9AB9E93u, 0xCE7C6CB1u, 0x22CC2FBBu, 0x4E6EFE69u,
+    0xFCB0B9A3u, 0x7B16D861u, 0xA70BE64Bu, 0x57428899u, 0x79D38FB3u, 0xE1A9AD11u,
+    0xA0033FDBu, 0xC69873C9u, 0x306AB0C3u, 0x759F1AC1u, 0x4B284C6Bu, 0x68256FF9u,
+    0xE56FACD3u, 0xD6C25171u, 0xE83C1BFBu, 0x44372D29u, 0x298F13E3u, 0x65EF8121u,
+    0x52DABE8Bu, 0x4AE45B59u, 0xBA3875F3u, 0x72C3D9D1u, 0x4F0B441Bu, 0x103CAA89u,
+    0xBDAE6303u, 0x324D8B81u, 0x98CFBCABu, 0x4978CAB9u, 0x6A166B13u, 0xAEBBC631u,
+    0xC6B5383Bu, 0xBB2A6BE9u, 0xA7891E23u, 0xE00EB9E1u, 0x0F63C6CBu, 0x486C3E19u,
+    0x3D220C33u, 0x1DC79691u, 0x022E785Bu, 0xD311F149u, 0x190FC543u, 0x19988C41u,
+    0x42A35CEBu, 0x9CD83579u, 0x43A3D953u, 0x9314CAF1u, 0x571B847Bu, 0xD994BAA9u,
+    0x0D62D863u, 0xF46082A1u, 0x9A4AFF0Bu, 0x226630D9u, 0x08145273u, 0x07E0E351u,
+    0x5FD0DC9Bu, 0x79E44809u, 0x5AD2D783u, 0xF6EC1D01u, 0x5BC72D2Bu, 0x914FB039u,
+    0x011BF793u, 0xC1795FB1u, 0x5D5300BBu, 0xFEC21969u, 0x84E042A3u, 0x5ED0DB61u,
+    0x6C34674Bu, 0x145E3399u, 0xC39348B3u, 0xB73BC011u, 0x595670DBu, 0x087FAEC9u,
+    0x4E3B99C3u, 0xA6B43DC1u, 0xD25F2D6Bu, 0x1EEB3AF9u, 0xF482C5D3u, 0x38958471u,
+    0x083FACFBu, 0x82FE8829u, 0x0AC55CE3u, 0x4C4BC421u, 0xF8C3FF8Bu, 0x82E04659u,
+    0xFB22EEF3u, 0xD3042CD1u, 0x6B23351Bu, 0xDBB02589u, 0xB18E0C03u, 0xD65CEE81u,
+    0xAF8F5DABu, 0xC6B6D5B9u, 0x72DC4413u, 0x78153931u, 0x31C5893Bu, 0x779606E9u,
+    0xAED62723u, 0x1ABD3CE1u, 0xEE9DC7CBu, 0xBB786919u, 0x5D474533u, 0xE3662991u,
+    0xDC9B295Bu, 0x6941AC49u, 0x760E2E43u, 0xC4522F41u, 0x577BBDEBu, 0x52BE8079u,
+    0x142C7253u, 0x40A47DF1u, 0x9EC8957Bu, 0x66D495A9u, 0xD3D6A163u, 0x191145A1u,
+    0x7765C00Bu, 0xB4B29BD9u, 0xFB844B73u, 0x118DB651u, 0x00224D9Bu, 0x00004309u,
+    0x00000083u, 0x00000001u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u,
+    0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u,
+    0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u
+};
+
+// Hash de referência (byte a byte): h = h * 131 + c
+unsigned int hashEscalar(const char* s) {
+    unsigned int h = 0;
+    for (int i = 0; s[i] != '\0'; i++) {
+        h = (h * 131) + (unsigned char)s[i];
+    }
+    return h;
+}
+
+// Mesmo resultado de hashEscalar para os 'tam' primeiros bytes de 's'
+// Com AVX2, blocos de 8 bytes vão pelo kernel vetorial; a sobra (menos de um bloco) é escalar,
+// então nada é lido depois do fim do texto.
+static unsigned int hashTexto(const char* s, unsigned int tam) {
+    const unsigned int* pesos = POT131 + (TAM_CHAVE - tam);
+    unsigned int i = 0, h;
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 8 <= tam; i += 8) {
+        __m256i c = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) (s + i)));
+        __m256i w = _mm256_loadu_si256((const __m256i*) (pesos + i));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(c, w));
+    }
+    __m128i s4 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, _MM_SHUFFLE(1, 0, 3, 2)));
+    s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, _MM_SHUFFLE(2, 3, 0, 1)));
+    h = (unsigned int) _mm_cvtsi128_si32(s4);
+#else
+    // SSE2 ou sem SIMD: Horner direto, como hashEscalar (o SSE2 não tem
+    // multiplicação 32x32 por faixa e a versão com _mm_mul_epu32 não ganhava nada)
+    h = 0;
+    for (; i < tam; i++) {
+        h = (h * 131) + (unsigned char)s[i];
+    }
+#endif
+    for (; i < tam; i++) {
+        h += (unsigned char)s[i] * pesos[i];
+    }
+    return h;
+}
+
+// [criarChave] Copia o texto para a chave (trunca em TAM_CHAVE - 1) e pré-calcula os campos
+void criarChave(ChavePista* k, const char* texto) {
+    size_t tam = strlen(texto);
+    if (tam > TAM_CHAVE - 1) tam = TAM_CHAVE - 1;
+    // Zera só o bloco onde fica o '\0' (tamanho fixo: vira uma única escrita vetorial)
+    memset(k->texto + (tam & ~(size_t) (BLOCO_CHAVE - 1)), 0, BLOCO_CHAVE);
+    memcpy(k->texto, texto, tam);
+    k->tam = (unsigned int) tam;
+    const unsigned char* u = (const unsigned char*) k->texto;
+    k->prefixo = ((unsigned int) u[0] << 24) | ((unsigned int) u[1] << 16)
+               | ((unsigned int) u[2] << 8)  |  (unsigned int) u[3];
+    // Hash lido do texto original: reler a chave logo após gravá-la com escritas
+    // menores que o bloco causaria espera no encaminhamento de store para load.
+    k->hash = hashTexto(texto, k->tam);
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+// Utilitário: posição do primeiro byte diferente entre as chaves (ou TAM_CHAVE se iguais)
+// Basta olhar até o '\0' da menor chave; o resto desse bloco é zero nas duas.
+static unsigned int primeiraDiferenca(const ChavePista* a, const ChavePista* b) {
+    unsigned int limite = (a->tam < b->tam ? a->tam : b->tam) + 1;
+#if defined(__AVX2__)
+    for (unsigned int i = 0; i < limite; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*) (a->texto + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*) (b->texto + i));
+        unsigned int iguais = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+        if (iguais != 0xFFFFFFFFu) return i + (unsigned int) __builtin_ctz(~iguais);
+    }
+#elif defined(__SSE2__)
+    for (unsigned int i = 0; i < limite; i += 16) {
+        __m128i va = _mm_load_si128((const __m128i*) (a->texto + i));
+        __m128i vb = _mm_load_si128((const __m128i*) (b->texto + i));
+        unsigned int iguais = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+        if (iguais != 0xFFFFu) return i + (unsigned int) __builtin_ctz(~iguais);
+    }
+#endif
+    return TAM_CHAVE;
+}
+#endif
+
+// [chavesIguais] Igualdade de chaves (equivale a strcmp(...) == 0)
+int chavesIguais(const ChavePista* a, const ChavePista* b) {
+    if (a->hash != b->hash || a->tam != b->tam || a->prefixo != b->prefixo) return 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    return primeiraDiferenca(a, b) == TAM_CHAVE;
+#else
+    // Sem SIMD, o memcmp da biblioteca é mais rápido que um laço próprio
+    return memcmp(a->texto, b->texto, a->tam) == 0;
+#endif
+}
+
+// [compararChaves] Ordenação de chaves com o mesmo sinal de strcmp
+int compararChaves(const ChavePista* a, const ChavePista* b) {
+    if (a->prefixo != b->prefixo) return (a->prefixo < b->prefixo) ? -1 : 1;
+#if defined(__AVX2__) || defined(__SSE2__)
+    unsigned int i = primeiraDiferenca(a, b);
+    if (i == TAM_CHAVE) return 0;
+    return (int) (unsigned char) a->texto[i] - (int) (unsigned char) b->texto[i];
+#else
+    return strcmp(a->texto, b->texto);
+#endif
+}
+
 
 // [criarSala] Cria dinamicamente um cômodo com nome e pista (opcional)
 // Se 'pista' for NULL, armazena string vazia "" (sem pista).
@@ -57,37 +246,44 @@ Sala* criarSala(const char* nome, const char* pista) {
 
 
 // Utilitário: cria nó de pista (interno da BST)
-static PistaNode* criarNoPista(const char* valor) {
+static PistaNode* criarNoPista(const ChavePista* valor) {
     PistaNode* novo = (PistaNode*) malloc(sizeof(PistaNode));
     if (novo == NULL) {
         printf("Erro ao alocar memória para a pista!\n");
         exit(1);
     }
-    strcpy(novo->valor, valor);
+    novo->valor = *valor;
     novo->esquerda = NULL;
     novo->direita  = NULL;
     return novo;
 }
 
-// [inserirPista] Insere pista na BST (ordem alfabética por strcmp)
-PistaNode* inserirPista(PistaNode* raiz, const char* valor) {
+// Utilitário: insere chave já preparada na BST
+static PistaNode* inserirPistaChave(PistaNode* raiz, const ChavePista* valor) {
     if (raiz == NULL) {
         return criarNoPista(valor);
     }
-    if (strcmp(valor, raiz->valor) < 0) {
-        raiz->esquerda = inserirPista(raiz->esquerda, valor);
+    if (compararChaves(valor, &raiz->valor) < 0) {
+        raiz->esquerda = inserirPistaChave(raiz->esquerda, valor);
     } else {
-        raiz->direita  = inserirPista(raiz->direita,  valor);
+        raiz->direita  = inserirPistaChave(raiz->direita,  valor);
     }
     return raiz;
 }
 
+// [inserirPista] Insere pista na BST (ordem alfabética, mesma ordem de strcmp)
+PistaNode* inserirPista(PistaNode* raiz, const char* valor) {
+    ChavePista chave;
+    criarChave(&chave, valor);
+    return inserirPistaChave(raiz, &chave);
+}
+
 
 // [exibirPistas] Imprime as pistas em ordem alfabética (em-ordem)
 void exibirPistas(PistaNode* raiz) {
     if (raiz != NULL) {
         exibirPistas(raiz->esquerda);
-        printf("- %s\n", raiz->valor);
+        printf("- %s\n", raiz->valor.texto);
         exibirPistas(raiz->direita);
     }
 }
@@ -95,13 +291,9 @@ void exibirPistas(PistaNode* raiz) {
 
 // Hash: criação e operações
 
-// Função de hash simples para string
-static unsigned int hashFunc(const char* s) {
-    unsigned int h = 0;
-    for (int i = 0; s[i] != '\0'; i++) {
-        h = (h * 131) + (unsigned char)s[i];
-    }
-    return h % TAM_HASH;
+// Bucket da chave (hash já calculado em criarChave)
+static unsigned int bucketChave(const ChavePista* k) {
+    return k->hash % TAM_HASH;
 }
 
 // Inicializa tabela hash
@@ -113,24 +305,39 @@ static void initHash(HashSuspeitos* h) {
 
 // [inserirNaHash] insere associação pista/suspeito na tabela hash
 void inserirNaHash(HashSuspeitos* h, const char* pista, const char* suspeito) {
-    unsigned int idx = hashFunc(pista);
     HashNode* novo = (HashNode*) malloc(sizeof(HashNode));
     if (!novo) {
         printf("Erro ao alocar memória na hash!\n");
         exit(1);
     }
-    strcpy(novo->chave, pista);
-    strcpy(novo->valor, suspeito);
+    criarChave(&novo->chave, pista);
+    criarChave(&novo->valor, suspeito);
+    unsigned int idx = bucketChave(&novo->chave);
     novo->prox = h->buckets[idx];
     h->buckets[idx] = novo;
 }
 
+// Utilitário: busca pela chave já preparada (retorna o suspeito ou NULL)
+static const ChavePista* encontrarSuspeitoChave(HashSuspeitos* h, const ChavePista* pista) {
+    unsigned int idx = bucketChave(pista);
+    for (HashNode* no = h->buckets[idx]; no != NULL; no = no->prox) {
+        if (chavesIguais(&no->chave, pista)) {
+            return &no->valor;
+        }
+    }
+    return NULL;
+}
+
 // [encontrarSuspeito] retorna o suspeito associado à pista (ou NULL se não houver)
+// Não monta uma ChavePista: calcula o hash direto do texto e só compara os bytes
+// das entradas com o mesmo hash e tamanho (mesmo truncamento de criarChave).
 const char* encontrarSuspeito(HashSuspeitos* h, const char* pista) {
-    unsigned int idx = hashFunc(pista);
-    for (HashNode* no = h->buckets[idx]; no != NULL; no = no->prox) {
-        if (strcmp(no->chave, pista) == 0) {
-            return no->valor;
+    size_t tam = strlen(pista);
+    if (tam > TAM_CHAVE - 1) tam = TAM_CHAVE - 1;
+    unsigned int hash = hashTexto(pista, (unsigned int) tam);
+    for (HashNode* no = h->buckets[hash % TAM_HASH]; no != NULL; no = no->prox) {
+        if (no->chave.hash == hash && no->chave.tam == tam && memcmp(no->chave.texto, pista, tam) == 0) {
+            return no->valor.texto;
         }
     }
     return NULL;
@@ -150,72 +357,378 @@ void liberarHash(HashSuspeitos* h) {
 }
 
 
+// Mapa em grafo: construção, conversão e percursos
+
+// Utilitário: realoca vetor do mapa ou encerra o programa
+static void* realocarMapa(void* ptr, size_t bytes) {
+    void* novo = realloc(ptr, bytes);
+    if (novo == NULL) {
+        printf("Erro ao alocar memória para o mapa!\n");
+        exit(1);
+    }
+    return novo;
+}
+
+// Inicializa mapa vazio
+static void initMapa(MapaGrafo* m) {
+    memset(m, 0, sizeof(*m));
+}
+
+// Utilitário: copia texto para a área única do mapa e retorna seu deslocamento
+static size_t guardarTexto(MapaGrafo* m, const char* texto) {
+    size_t tam = strlen(texto) + 1;
+    if (m->usoTextos + tam > m->capTextos) {
+        size_t cap = m->capTextos ? m->capTextos : 256;
+        while (m->usoTextos + tam > cap) cap *= 2;
+        m->textos = (char*) realocarMapa(m->textos, cap);
+        m->capTextos = cap;
+    }
+    size_t off = m->usoTextos;
+    memcpy(m->textos + off, texto, tam);
+    m->usoTextos += tam;
+    return off;
+}
+
+// [adicionarSalaMapa] Cria um cômodo no mapa e retorna seu índice
+// Se 'pista' for NULL ou "", o cômodo fica sem pista.
+int adicionarSalaMapa(MapaGrafo* m, const char* nome, const char* pista) {
+    if (m->inicio != NULL) {
+        printf("Mapa já finalizado: não é possível adicionar novas salas!\n");
+        exit(1);
+    }
+    if (m->numSalas == m->capSalas) {
+        int cap = m->capSalas ? m->capSalas * 2 : 16;
+        m->nomeOff  = (size_t*) realocarMapa(m->nomeOff,  (size_t) cap * sizeof(size_t));
+        m->pistaOff = (size_t*) realocarMapa(m->pistaOff, (size_t) cap * sizeof(size_t));
+        m->saidaEsquerda = (signed char*) realocarMapa(m->saidaEsquerda, (size_t) cap);
+        m->saidaDireita  = (signed char*) realocarMapa(m->saidaDireita,  (size_t) cap);
+        m->capSalas = cap;
+    }
+    int id = m->numSalas++;
+    m->nomeOff[id]  = guardarTexto(m, nome);
+    m->pistaOff[id] = (pista != NULL && pista[0] != '\0') ? guardarTexto(m, pista) : SEM_PISTA;
+    m->saidaEsquerda[id] = SEM_LADO;
+    m->saidaDireita[id]  = SEM_LADO;
+    return id;
+}
+
+// [conectarSalas] Registra uma passagem de 'origem' para 'destino'
+// As saídas de cada cômodo mantêm a ordem em que foram conectadas.
+void conectarSalas(MapaGrafo* m, int origem, int destino) {
+    if (origem < 0 || origem >= m->numSalas || destino < 0 || destino >= m->numSalas) {
+        printf("Conexão inválida: sala %d -> %d (o mapa tem %d salas)!\n", origem, destino, m->numSalas);
+        exit(1);
+    }
+    if (m->inicio != NULL) {
+        printf("Mapa já finalizado: não é possível conectar novas salas!\n");
+        exit(1);
+    }
+    if (m->numConexoes == m->capConexoes) {
+        int cap = m->capConexoes ? m->capConexoes * 2 : 16;
+        m->origens  = (int*) realocarMapa(m->origens,  (size_t) cap * sizeof(int));
+        m->destinos = (int*) realocarMapa(m->destinos, (size_t) cap * sizeof(int));
+        m->capConexoes = cap;
+    }
+    m->origens[m->numConexoes]  = origem;
+    m->destinos[m->numConexoes] = destino;
+    m->numConexoes++;
+}
+
+// [finalizarMapa] Agrupa as conexões por origem (ordenação por contagem, estável)
+// Deve ser chamada depois de todas as salas e conexões serem adicionadas.
+void finalizarMapa(MapaGrafo* m) {
+    if (m->inicio != NULL) {
+        printf("Mapa já finalizado!\n");
+        exit(1);
+    }
+    int* inicio = (int*) calloc((size_t) m->numSalas + 1, sizeof(int));
+    int* pos    = (int*) malloc(((size_t) m->numSalas + 1) * sizeof(int));
+    int* csr    = (int*) malloc(((size_t) m->numConexoes + 1) * sizeof(int));
+    if (inicio == NULL || pos == NULL || csr == NULL) {
+        printf("Erro ao alocar memória para o mapa!\n");
+        exit(1);
+    }
+    for (int e = 0; e < m->numConexoes; e++) {
+        inicio[m->origens[e] + 1]++;
+    }
+    for (int i = 0; i < m->numSalas; i++) {
+        inicio[i + 1] += inicio[i];
+    }
+    memcpy(pos, inicio, (size_t) m->numSalas * sizeof(int));
+    for (int e = 0; e < m->numConexoes; e++) {
+        csr[pos[m->origens[e]]++] = m->destinos[e];
+    }
+    free(pos);
+    free(m->origens);
+    free(m->destinos);
+    m->origens  = NULL;
+    m->destinos = csr;
+    m->inicio   = inicio;
+    m->capConexoes = m->numConexoes;
+}
+
+// Consultas ao mapa (válidas após finalizarMapa)
+static const char* nomeSala(const MapaGrafo* m, int sala) {
+    return m->textos + m->nomeOff[sala];
+}
+
+static const char* pistaSala(const MapaGrafo* m, int sala) {
+    return (m->pistaOff[sala] == SEM_PISTA) ? NULL : m->textos + m->pistaOff[sala];
+}
+
+static int numSaidas(const MapaGrafo* m, int sala) {
+    return m->inicio[sala + 1] - m->inicio[sala];
+}
+
+// [carregarMapaDeArvore] Converte um mapa em árvore binária (Sala) para o grafo
+// Cada nó vira um cômodo com até duas saídas, na ordem esquerda -> direita; o lado de
+// origem de cada saída fica registrado para os comandos 'e'/'d' (lados vazios não viram saída).
+// Percurso iterativo em largura (sem recursão). Retorna o índice da raiz ou -1.
+int carregarMapaDeArvore(MapaGrafo* m, Sala* raiz) {
+    if (raiz == NULL) return -1;
+
+    size_t cap = 16, ini = 0, fim = 0;
+    Sala** fila = (Sala**) realocarMapa(NULL, cap * sizeof(Sala*));
+    int*   ids  = (int*)   realocarMapa(NULL, cap * sizeof(int));
+
+    int idRaiz = adicionarSalaMapa(m, raiz->nome, raiz->pista);
+    fila[fim] = raiz;
+    ids[fim++] = idRaiz;
+
+    while (ini < fim) {
+        Sala* atual = fila[ini];
+        int idAtual = ids[ini++];
+        Sala* filhos[2] = { atual->esquerda, atual->direita };
+        signed char saida = 0;
+        for (int k = 0; k < 2; k++) {
+            if (filhos[k] == NULL) continue;
+            if (k == 0) m->saidaEsquerda[idAtual] = saida++;
+            else        m->saidaDireita[idAtual]  = saida++;
+            if (fim == cap) {
+                cap *= 2;
+                fila = (Sala**) realocarMapa(fila, cap * sizeof(Sala*));
+                ids  = (int*)   realocarMapa(ids,  cap * sizeof(int));
+            }
+            int idFilho = adicionarSalaMapa(m, filhos[k]->nome, filhos[k]->pista);
+            conectarSalas(m, idAtual, idFilho);
+            fila[fim] = filhos[k];
+            ids[fim++] = idFilho;
+        }
+    }
+
+    free(fila);
+    free(ids);
+    return idRaiz;
+}
+
+// Conjunto de cômodos visitados (1 bit por sala)
+static unsigned char* criarVisitados(int numSalas) {
+    unsigned char* v = (unsigned char*) calloc(((size_t) numSalas + 7) / 8, 1);
+    if (v == NULL) {
+        printf("Erro ao alocar memória para o mapa!\n");
+        exit(1);
+    }
+    return v;
+}
+
+static int foiVisitada(const unsigned char* v, int sala) {
+    return (v[sala >> 3] >> (sala & 7)) & 1;
+}
+
+static void marcarVisitada(unsigned char* v, int sala) {
+    v[sala >> 3] |= (unsigned char) (1u << (sala & 7));
+}
+
+// [buscaEmLargura] Distância (em passagens) de 'origem' até cada cômodo
+// 'dist' deve ter numSalas posições; recebe -1 nos cômodos inalcançáveis.
+// Retorna quantos cômodos são alcançáveis a partir de 'origem'.
+int buscaEmLargura(const MapaGrafo* m, int origem, int* dist) {
+    for (int i = 0; i < m->numSalas; i++) dist[i] = -1;
+    if (origem < 0 || origem >= m->numSalas) return 0;
+
+    int* fila = (int*) realocarMapa(NULL, (size_t) m->numSalas * sizeof(int));
+    int ini = 0, fim = 0;
+    dist[origem] = 0;
+    fila[fim++] = origem;
+    while (ini < fim) {
+        int u = fila[ini++];
+        for (int e = m->inicio[u]; e < m->inicio[u + 1]; e++) {
+            int v = m->destinos[e];
+            if (dist[v] < 0) {
+                dist[v] = dist[u] + 1;
+                fila[fim++] = v;
+            }
+        }
+    }
+    free(fila);
+    return fim;
+}
+
+// [buscaEmProfundidade] Ordem de descoberta (pré-ordem) a partir de 'origem'
+// Pilha explícita: as saídas são visitadas na ordem em que foram conectadas,
+// igual à versão recursiva, mas sem risco de estouro de pilha em mapas grandes.
+// 'ordem' deve ter numSalas posições. Retorna quantos cômodos foram visitados.
+int buscaEmProfundidade(const MapaGrafo* m, int origem, int* ordem) {
+    if (origem < 0 || origem >= m->numSalas) return 0;
+
+    unsigned char* visitados = criarVisitados(m->numSalas);
+    int* pilha = (int*) realocarMapa(NULL, ((size_t) m->numConexoes + 1) * sizeof(int));
+    int topo = 0, total = 0;
+    pilha[topo++] = origem;
+    while (topo > 0) {
+        int u = pilha[--topo];
+        if (foiVisitada(visitados, u)) continue;
+        marcarVisitada(visitados, u);
+        ordem[total++] = u;
+        // Empilha em ordem reversa para desempilhar a primeira saída antes
+        for (int e = m->inicio[u + 1] - 1; e >= m->inicio[u]; e--) {
+            if (!foiVisitada(visitados, m->destinos[e])) {
+                pilha[topo++] = m->destinos[e];
+            }
+        }
+    }
+    free(pilha);
+    free(visitados);
+    return total;
+}
+
+// Liberação do mapa
+void liberarMapa(MapaGrafo* m) {
+    free(m->nomeOff);
+    free(m->pistaOff);
+    free(m->saidaEsquerda);
+    free(m->saidaDireita);
+    free(m->textos);
+    free(m->origens);
+    free(m->destinos);
+    free(m->inicio);
+    initMapa(m);
+}
+
+
+// Resultado de coletarPistaDaSala
+#define COLETA_SEM_PISTA    0
+#define COLETA_PISTA        1
+#define COLETA_JA_VISITADA  2
+
+// [coletarPistaDaSala] Marca a sala como visitada e, na primeira visita, insere sua pista na BST
+static int coletarPistaDaSala(const MapaGrafo* mapa, int sala, unsigned char* visitados, PistaNode** pistasRaiz) {
+    if (foiVisitada(visitados, sala)) return COLETA_JA_VISITADA;
+    marcarVisitada(visitados, sala);
+    const char* pista = pistaSala(mapa, sala);
+    if (pista == NULL) return COLETA_SEM_PISTA;
+    *pistasRaiz = inserirPista(*pistasRaiz, pista);
+    return COLETA_PISTA;
+}
+
+// Resultado de interpretarEscolha (valores >= 0 são o índice da saída escolhida)
+#define ESCOLHA_SAIR          (-1)
+#define ESCOLHA_INVALIDA      (-2)
+#define ESCOLHA_SEM_ESQUERDA  (-3)
+#define ESCOLHA_SEM_DIREITA   (-4)
+
+// [interpretarEscolha] Converte a entrada do jogador em uma saída da sala
+// Aceita o número da saída (1..n), 's' para sair e 'e'/'d' para o lado esquerdo/direito
+// registrado por carregarMapaDeArvore (não é a "saída 1/2": lados vazios não viram saída).
+static int interpretarEscolha(const MapaGrafo* mapa, int sala, const char* entrada) {
+    int saidas = numSaidas(mapa, sala);
+    if (entrada[0] != '\0' && entrada[1] == '\0') {
+        switch (entrada[0]) {
+            case 's': case 'S':
+                return ESCOLHA_SAIR;
+            case 'e': case 'E':
+                return (mapa->saidaEsquerda[sala] == SEM_LADO) ? ESCOLHA_SEM_ESQUERDA : mapa->saidaEsquerda[sala];
+            case 'd': case 'D':
+                return (mapa->saidaDireita[sala] == SEM_LADO) ? ESCOLHA_SEM_DIREITA : mapa->saidaDireita[sala];
+        }
+    }
+    char* fimNum;
+    long op = strtol(entrada, &fimNum, 10);
+    if (entrada[0] == '\0' || *fimNum != '\0' || op < 1 || op > saidas) return ESCOLHA_INVALIDA;
+    return (int) (op - 1);
+}
+
 // [explorarSalasComPistas] Navegação e coleta de pistas
-void explorarSalasComPistas(Sala* atual, PistaNode** pistasRaiz) {
-    if (atual == NULL) {
+// Cômodos já visitados não repetem a pista (o mapa pode ter ciclos).
+void explorarSalasComPistas(const MapaGrafo* mapa, int inicio, PistaNode** pistasRaiz) {
+    if (inicio < 0 || inicio >= mapa->numSalas) {
         printf("Mapa vazio. Nada para explorar.\n");
         return;
     }
 
     printf("\n=== Detective Quest: Exploração da Mansão (Coleta de Pistas) ===\n");
 
-    while (1) {
-        // Exibe a sala atual
-        printf("\nVocê está em: %s\n", atual->nome);
+    unsigned char* visitados = criarVisitados(mapa->numSalas);
+    int atual = inicio;
+    int entrouNaSala = 1;
 
-        // Coleta automática da pista
-        if (atual->pista[0] != '\0') {
-            printf("Pista encontrada aqui: \"%s\"\n", atual->pista);
-            *pistasRaiz = inserirPista(*pistasRaiz, atual->pista);
-        } else {
-            printf("Nenhuma pista neste cômodo.\n");
-        }
+    while (1) {
+        int saidas = numSaidas(mapa, atual);
+
+        // Só ao entrar na sala (não depois de uma escolha inválida)
+        if (entrouNaSala) {
+            entrouNaSala = 0;
+            printf("\nVocê está em: %s\n", nomeSala(mapa, atual));
+
+            // Coleta automática da pista (apenas na primeira visita)
+            int coleta = coletarPistaDaSala(mapa, atual, visitados, pistasRaiz);
+            if (coleta == COLETA_JA_VISITADA) {
+                printf("Você já vasculhou este cômodo.\n");
+            } else if (coleta == COLETA_PISTA) {
+                printf("Pista encontrada aqui: \"%s\"\n", pistaSala(mapa, atual));
+            } else {
+                printf("Nenhuma pista neste cômodo.\n");
+            }
 
-        // Se for nó-folha, termina exploração automaticamente
-        if (atual->esquerda == NULL && atual->direita == NULL) {
-            printf("\nVocê chegou ao último cômodo deste caminho. Encerrando exploração...\n");
-            break;
+            // Sem saídas, termina exploração automaticamente
+            if (saidas == 0) {
+                printf("\nVocê chegou ao último cômodo deste caminho. Encerrando exploração...\n");
+                break;
+            }
         }
 
-        // Mostra opções de navegação
+        // Mostra opções de navegação ('e'/'d' aparecem na saída que veio daquele lado)
         printf("Caminhos disponíveis:\n");
-        printf("  [e] Esquerda: %s\n", (atual->esquerda ? atual->esquerda->nome : "-- indisponível --"));
-        printf("  [d] Direita : %s\n", (atual->direita  ? atual->direita->nome  : "-- indisponível --"));
+        for (int k = 0; k < saidas; k++) {
+            int destino = mapa->destinos[mapa->inicio[atual] + k];
+            const char* atalho = (k == mapa->saidaEsquerda[atual]) ? "/e"
+                               : (k == mapa->saidaDireita[atual])  ? "/d" : "";
+            printf("  [%d%s] %s%s\n", k + 1, atalho, nomeSala(mapa, destino),
+                   foiVisitada(visitados, destino) ? " (já visitado)" : "");
+        }
         printf("  [s] Sair do jogo (sem julgamento)\n");
 
-        printf("Escolha (e/d/s): ");
-        char op;
-        if (scanf(" %c", &op) != 1) {
+        printf("Escolha (1-%d, e/d ou s): ", saidas);
+        char entrada[16];
+        if (scanf(" %15s", entrada) != 1) {
             int c;
             while ((c = getchar()) != '\n' && c != EOF);
             printf("Entrada inválida. Tente novamente.\n");
             continue;
         }
 
-        if (op == 's' || op == 'S') {
+        int escolha = interpretarEscolha(mapa, atual, entrada);
+        if (escolha == ESCOLHA_SAIR) {
             printf("Saindo do jogo por solicitação do jogador.\n");
-            return;
-        } else if (op == 'e' || op == 'E') {
-            if (atual->esquerda) {
-                atual = atual->esquerda;
-            } else {
-                printf("Não há caminho à esquerda a partir de %s. Escolha novamente.\n", atual->nome);
-            }
-        } else if (op == 'd' || op == 'D') {
-            if (atual->direita) {
-                atual = atual->direita;
-            } else {
-                printf("Não há caminho à direita a partir de %s. Escolha novamente.\n", atual->nome);
-            }
+            break;
+        } else if (escolha == ESCOLHA_SEM_ESQUERDA) {
+            printf("Não há caminho à esquerda a partir de %s. Escolha novamente.\n", nomeSala(mapa, atual));
+        } else if (escolha == ESCOLHA_SEM_DIREITA) {
+            printf("Não há caminho à direita a partir de %s. Escolha novamente.\n", nomeSala(mapa, atual));
+        } else if (escolha == ESCOLHA_INVALIDA) {
+            printf("Opção inválida. Use um número de 1 a %d, 'e', 'd' ou 's'.\n", saidas);
         } else {
-            printf("Opção inválida. Use 'e', 'd' ou 's'.\n");
+            atual = mapa->destinos[mapa->inicio[atual] + escolha];
+            entrouNaSala = 1;
         }
     }
+
+    free(visitados);
 }
 
-// [explorarSalas] Navega pela arvore e ativa o sistema de pistas
-void explorarSalas(Sala* inicio, PistaNode** pistasRaiz) {
-    explorarSalasComPistas(inicio, pistasRaiz);
+// [explorarSalas] Navega pelo mapa e ativa o sistema de pistas
+void explorarSalas(const MapaGrafo* mapa, int inicio, PistaNode** pistasRaiz) {
+    explorarSalasComPistas(mapa, inicio, pistasRaiz);
 }
 
 
@@ -238,11 +751,11 @@ void liberarArvorePistas(PistaNode* raiz) {
 
 // Julgamento final
 // Percorre BST e conta quantas pistas apontam para o suspeito acusado
-static void contarPistasDoSuspeito(PistaNode* raiz, HashSuspeitos* h, const char* acusado, int* contador) {
+static void contarPistasDoSuspeito(PistaNode* raiz, HashSuspeitos* h, const ChavePista* acusado, int* contador) {
     if (raiz == NULL) return;
     contarPistasDoSuspeito(raiz->esquerda, h, acusado, contador);
-    const char* s = encontrarSuspeito(h, raiz->valor);
-    if (s != NULL && strcmp(s, acusado) == 0) {
+    const ChavePista* s = encontrarSuspeitoChave(h, &raiz->valor);
+    if (s != NULL && chavesIguais(s, acusado)) {
         (*contador)++;
     }
     contarPistasDoSuspeito(raiz->direita, h, acusado, contador);
@@ -279,8 +792,10 @@ void verificarSuspeitoFinal(PistaNode* pistas, HashSuspeitos* hashSus) {
     if (len > 0 && acusado[len-1] == '\n') acusado[len-1] = '\0';
 
     // Conta evidências
+    ChavePista chaveAcusado;
+    criarChave(&chaveAcusado, acusado);
     int cont = 0;
-    contarPistasDoSuspeito(pistas, hashSus, acusado, &cont);
+    contarPistasDoSuspeito(pistas, hashSus, &chaveAcusado, &cont);
 
     // Resultado (ganha/perde)
     printf("\n=== Julgamento Final ===\n");
@@ -292,6 +807,8 @@ void verificarSuspeitoFinal(PistaNode* pistas, HashSuspeitos* hashSus) {
 }
 
 // [main] Mapa fixo da mansão, hash de suspeitos, exploração e julgamento
+// Compile com -DDQ_SEM_MAIN para incluir este arquivo em outro programa (ex.: benchmark).
+#ifndef DQ_SEM_MAIN
 int main(void) {
 
     //Mansão
@@ -311,6 +828,13 @@ int main(void) {
     biblioteca->esquerda = escritorio;
     biblioteca->direita  = quarto;
 
+    // Carrega a árvore no mapa em grafo (mesma estrutura e ordem das saídas)
+    MapaGrafo mapa;
+    initMapa(&mapa);
+    int inicio = carregarMapaDeArvore(&mapa, hall);
+    finalizarMapa(&mapa);
+    liberarArvoreSalas(hall);
+
     //BST de pistas coletadas
     PistaNode* pistas = NULL;
 
@@ -328,7 +852,7 @@ int main(void) {
     inserirNaHash(&hash, "Chave perdida sob o tapete",       "Bibliotecário");
 
     //Explora um único caminho coletando pistas
-    explorarSalas(hall, &pistas);
+    explorarSalas(&mapa, inicio, &pistas);
 
     //Julgamento final
     verificarSuspeitoFinal(pistas, &hash);
@@ -336,7 +860,8 @@ int main(void) {
     //Liberação de memória
     liberarHash(&hash);
     liberarArvorePistas(pistas);
-    liberarArvoreSalas(hall);
+    liberarMapa(&mapa);
 
     return 0;
 }
+#endif
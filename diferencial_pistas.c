@@ -0,0 +1,650 @@
+/*
+Detective Quest - Teste diferencial das estruturas principais
+Executa longas sequências aleatórias de operações na implementação de referência
+(BST com strcmp, hash com hashFunc byte a byte e árvore Sala) e na implementação atual
+de detetiveQuest_final.c (ChavePista, HashSuspeitos e MapaGrafo), comparando:
+  - saída em-ordem da BST de pistas (incluindo duplicatas, que vão para a direita);
+  - bucket e resultado de cada busca na tabela hash de suspeitos;
+  - contagem de pistas do acusado e o veredito (cont >= 2);
+  - conversão da árvore Sala para o grafo, percursos em largura/profundidade e caminhos
+    escolhidos pelo lado da árvore (e/d do jogo), inclusive salas só com filho direito;
+  - grafos aleatórios com ciclos e salas compartilhadas: agrupamento das saídas, percursos
+    contra versões recursivas simples e coleta de pista só na primeira visita;
+  - chaves de 100 a 127 bytes e acima de 127 (truncadas) contra strcmp/hashEscalar.
+
+Compilação e uso:
+  gcc -O2 -pthread diferencial_pistas.c -o diferencial_pistas
+  ./diferencial_pistas [threads] [milhões de operações por thread] [semente]
+Cada thread usa a semente + seu número; uma divergência imprime a semente e a rodada.
+*/
+
+#define DQ_SEM_MAIN
+#include "detetiveQuest_final.c"
+#include "referencia_original.c"
+
+#include <pthread.h>
+#include <time.h>
+
+#define MAX_THREADS 256
+
+
+// Estado de cada thread
+
+typedef struct {
+    int id;
+    unsigned int semente;
+    long long opsAlvo;
+    long long ops;        // operações comparadas
+    long long rodadas;
+    int divergiu;         // 1 se encontrou diferença
+    char mensagem[256];   // descrição da primeira diferença
+} Trabalho;
+
+// Gerador por thread (xorshift32); rand() não é seguro entre threads
+static unsigned int aleatorio(unsigned int* s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static const char* SUSPEITOS[] = {
+    "Jardineiro", "Camareira", "Bibliotecário", "Administrador", "Cozinheiro"
+};
+#define NUM_SUSPEITOS ((int) (sizeof(SUSPEITOS) / sizeof(SUSPEITOS[0])))
+
+// Alfabeto pequeno (com bytes UTF-8 acima de 127) para forçar prefixos comuns,
+// duplicatas e comparações que dependem de o byte ser tratado como unsigned char.
+static const char ALFABETO[] = "aab Pp\xC3\xA7\xC3\xA3~";
+#define TAM_ALFABETO ((int) (sizeof(ALFABETO) - 1))
+
+#define MAX_SORTEADAS 64
+
+// Sorteia texto de 0 a TAM_TEXTO_REF-1 bytes; muitas vezes repete ou altera um anterior
+static void sortearTexto(unsigned int* s, char anteriores[][TAM_TEXTO_REF], int* numAnteriores, char* destino) {
+    unsigned int modo = aleatorio(s) % 8;
+    if (*numAnteriores > 0 && modo < 3) {
+        // repete um texto anterior (duplicata exata)
+        strcpy(destino, anteriores[aleatorio(s) % (unsigned int) *numAnteriores]);
+        return;
+    }
+    int tam;
+    if (*numAnteriores > 0 && modo < 6) {
+        // mesmo prefixo de um anterior, com cauda alterada
+        strcpy(destino, anteriores[aleatorio(s) % (unsigned int) *numAnteriores]);
+        tam = (int) strlen(destino);
+        int corte = tam ? (int) (aleatorio(s) % (unsigned int) (tam + 1)) : 0;
+        int extra = (int) (aleatorio(s) % 8);
+        if (corte + extra > TAM_TEXTO_REF - 1) extra = TAM_TEXTO_REF - 1 - corte;
+        for (int i = 0; i < extra; i++) destino[corte + i] = ALFABETO[aleatorio(s) % TAM_ALFABETO];
+        tam = corte + extra;
+    } else {
+        // texto novo; a maioria com tamanho parecido com o das pistas do jogo
+        tam = (aleatorio(s) % 16 == 0) ? (int) (aleatorio(s) % TAM_TEXTO_REF)
+                                       : (int) (aleatorio(s) % 40);
+        for (int i = 0; i < tam; i++) destino[i] = ALFABETO[aleatorio(s) % TAM_ALFABETO];
+    }
+    destino[tam] = '\0';
+
+    if (*numAnteriores < MAX_SORTEADAS) {
+        strcpy(anteriores[(*numAnteriores)++], destino);
+    } else {
+        strcpy(anteriores[aleatorio(s) % MAX_SORTEADAS], destino);
+    }
+}
+
+static int divergir(Trabalho* t, const char* fase, const char* detalhe) {
+    t->divergiu = 1;
+    snprintf(t->mensagem, sizeof(t->mensagem), "thread %d, semente %u, rodada %lld, fase %s: %s",
+             t->id, t->semente, t->rodadas, fase, detalhe);
+    return 0;
+}
+
+
+// Comparações
+
+// Coleta em-ordem (o que exibirPistas imprime) das duas BSTs
+static void emOrdemRef(RefPistaNode* raiz, const char** saida, int* n) {
+    if (raiz == NULL) return;
+    emOrdemRef(raiz->esquerda, saida, n);
+    saida[(*n)++] = raiz->valor;
+    emOrdemRef(raiz->direita, saida, n);
+}
+
+static void emOrdemNova(PistaNode* raiz, const char** saida, int* n) {
+    if (raiz == NULL) return;
+    emOrdemNova(raiz->esquerda, saida, n);
+    saida[(*n)++] = raiz->valor.texto;
+    emOrdemNova(raiz->direita, saida, n);
+}
+
+#define MAX_INSERCOES 512
+
+// Rodada de pistas: BST + hash + veredito
+static int rodadaPistas(Trabalho* t, unsigned int* s) {
+    static _Thread_local char anteriores[MAX_SORTEADAS][TAM_TEXTO_REF];
+    static _Thread_local const char* ordemRef[MAX_INSERCOES];
+    static _Thread_local const char* ordemNova[MAX_INSERCOES];
+    int numAnteriores = 0;
+    char texto[TAM_TEXTO_REF];
+
+    RefPistaNode* refPistas = NULL;
+    PistaNode* pistas = NULL;
+    RefHashSuspeitos refHash;
+    HashSuspeitos hash;
+    for (int i = 0; i < TAM_HASH; i++) refHash.buckets[i] = NULL;
+    initHash(&hash);
+    int ok = 1;
+
+    // Associações pista -> suspeito (chaves repetidas: vale a última inserida)
+    int numAssoc = (int) (aleatorio(s) % MAX_INSERCOES);
+    for (int i = 0; i < numAssoc && ok; i++, t->ops++) {
+        sortearTexto(s, anteriores, &numAnteriores, texto);
+        const char* suspeito = SUSPEITOS[aleatorio(s) % NUM_SUSPEITOS];
+        refInserirNaHash(&refHash, texto, suspeito);
+        inserirNaHash(&hash, texto, suspeito);
+        ChavePista k;
+        criarChave(&k, texto);
+        if (bucketChave(&k) != refHashFunc(texto) || k.hash != hashEscalar(texto)) {
+            ok = divergir(t, "hash", texto);
+        }
+    }
+
+    // Inserções na BST
+    int numPistas = 1 + (int) (aleatorio(s) % MAX_INSERCOES);
+    for (int i = 0; i < numPistas && ok; i++, t->ops++) {
+        sortearTexto(s, anteriores, &numAnteriores, texto);
+        refPistas = refInserirPista(refPistas, texto);
+        pistas = inserirPista(pistas, texto);
+    }
+    if (ok) {
+        int nRef = 0, nNova = 0;
+        emOrdemRef(refPistas, ordemRef, &nRef);
+        emOrdemNova(pistas, ordemNova, &nNova);
+        if (nRef != nNova) ok = divergir(t, "em-ordem", "quantidade de pistas diferente");
+        for (int i = 0; i < nRef && ok; i++) {
+            if (strcmp(ordemRef[i], ordemNova[i]) != 0) ok = divergir(t, "em-ordem", ordemRef[i]);
+        }
+        t->ops += nRef;
+    }
+
+    // Buscas (existentes e inexistentes)
+    for (int i = 0; i < numPistas && ok; i++, t->ops++) {
+        sortearTexto(s, anteriores, &numAnteriores, texto);
+        const char* a = refEncontrarSuspeito(&refHash, texto);
+        const char* b = encontrarSuspeito(&hash, texto);
+        if ((a == NULL) != (b == NULL) || (a != NULL && strcmp(a, b) != 0)) {
+            ok = divergir(t, "busca", texto);
+        }
+    }
+
+    // Veredito para cada suspeito, para um nome parecido (mesmo prefixo) e para um sorteado
+    for (int i = 0; i < NUM_SUSPEITOS + 2 && ok; i++, t->ops++) {
+        const char* acusado = SUSPEITOS[i % NUM_SUSPEITOS];
+        if (i == NUM_SUSPEITOS) {
+            strcpy(texto, SUSPEITOS[aleatorio(s) % NUM_SUSPEITOS]);
+            size_t tam = strlen(texto);
+            if (aleatorio(s) % 2) texto[4 + aleatorio(s) % (tam - 4)] = '\0';
+            else { texto[tam] = ALFABETO[aleatorio(s) % TAM_ALFABETO]; texto[tam + 1] = '\0'; }
+            acusado = texto;
+        } else if (i == NUM_SUSPEITOS + 1) {
+            sortearTexto(s, anteriores, &numAnteriores, texto);
+            texto[49] = '\0'; // mesmo limite do campo de acusação
+            acusado = texto;
+        }
+        int contRef = 0, contNovo = 0;
+        refContarPistasDoSuspeito(refPistas, &refHash, acusado, &contRef);
+        ChavePista chaveAcusado;
+        criarChave(&chaveAcusado, acusado);
+        contarPistasDoSuspeito(pistas, &hash, &chaveAcusado, &contNovo);
+        if (contRef != contNovo || (contRef >= 2) != (contNovo >= 2)) {
+            ok = divergir(t, "veredito", acusado);
+        }
+    }
+
+    refLiberarPistas(refPistas);
+    liberarArvorePistas(pistas);
+    refLiberarHash(&refHash);
+    liberarHash(&hash);
+    return ok;
+}
+
+#define MAX_SALAS 256
+
+// Rodada do mapa: árvore Sala aleatória x grafo carregado a partir dela
+static int rodadaMapa(Trabalho* t, unsigned int* s) {
+    static _Thread_local Sala* salas[MAX_SALAS];
+    static _Thread_local Sala* fila[MAX_SALAS];
+    static _Thread_local int profundidade[MAX_SALAS];
+    static _Thread_local int preOrdem[MAX_SALAS];
+    static _Thread_local int ordem[MAX_SALAS];
+    static _Thread_local int dist[MAX_SALAS];
+    char nome[50];
+
+    // Árvore aleatória: cada sala nova vai para um lado livre de uma sala existente.
+    // Às vezes só pela direita (corredor em que toda sala tem apenas o filho direito).
+    int n = 1 + (int) (aleatorio(s) % MAX_SALAS);
+    int soDireita = (aleatorio(s) % 8 == 0);
+    for (int i = 0; i < n; i++) {
+        snprintf(nome, sizeof(nome), "Sala %d", i);
+        salas[i] = criarSala(nome, (aleatorio(s) % 3) ? nome : NULL);
+        if (soDireita && i > 0) {
+            salas[i - 1]->direita = salas[i];
+            continue;
+        }
+        while (i > 0) {
+            Sala* pai = salas[aleatorio(s) % (unsigned int) i];
+            Sala** lado = (aleatorio(s) % 2) ? &pai->esquerda : &pai->direita;
+            if (*lado == NULL) {
+                *lado = salas[i];
+                break;
+            }
+        }
+    }
+
+    MapaGrafo mapa;
+    initMapa(&mapa);
+    int inicio = carregarMapaDeArvore(&mapa, salas[0]);
+    finalizarMapa(&mapa);
+    int ok = 1;
+    if (inicio != 0 || mapa.numSalas != n || mapa.numConexoes != n - 1) {
+        ok = divergir(t, "carregar", "tamanho do mapa diferente");
+    }
+
+    // Largura: índices do grafo seguem a ordem por níveis da árvore
+    if (ok) {
+        int ini = 0, fim = 0;
+        fila[fim] = salas[0];
+        profundidade[fim++] = 0;
+        while (ini < fim) {
+            Sala* sala = fila[ini];
+            int p = profundidade[ini++];
+            if (sala->esquerda) { fila[fim] = sala->esquerda; profundidade[fim++] = p + 1; }
+            if (sala->direita)  { fila[fim] = sala->direita;  profundidade[fim++] = p + 1; }
+        }
+        int alcancadas = buscaEmLargura(&mapa, inicio, dist);
+        if (alcancadas != n) ok = divergir(t, "largura", "salas alcançáveis diferente");
+        for (int i = 0; i < n && ok; i++, t->ops++) {
+            const char* pista = pistaSala(&mapa, i);
+            if (strcmp(nomeSala(&mapa, i), fila[i]->nome) != 0 || dist[i] != profundidade[i]
+                || strcmp(pista ? pista : "", fila[i]->pista) != 0) {
+                ok = divergir(t, "largura", fila[i]->nome);
+            }
+        }
+    }
+
+    // Profundidade: pré-ordem da árvore (esquerda antes da direita)
+    if (ok) {
+        int topo = 0, total = 0;
+        fila[topo++] = salas[0];
+        while (topo > 0) {
+            Sala* sala = fila[--topo];
+            preOrdem[total++] = atoi(sala->nome + 5);
+            if (sala->direita)  fila[topo++] = sala->direita;
+            if (sala->esquerda) fila[topo++] = sala->esquerda;
+        }
+        int visitadas = buscaEmProfundidade(&mapa, inicio, ordem);
+        if (visitadas != total) ok = divergir(t, "profundidade", "salas visitadas diferente");
+        for (int i = 0; i < total && ok; i++, t->ops++) {
+            if (atoi(nomeSala(&mapa, ordem[i]) + 5) != preOrdem[i]) {
+                ok = divergir(t, "profundidade", nomeSala(&mapa, ordem[i]));
+            }
+        }
+    }
+
+    // Caminhos: escolhas aleatórias até uma folha, nos dois mapas ao mesmo tempo
+    for (int caminho = 0; caminho < 4 && ok; caminho++) {
+        Sala* sala = salas[0];
+        int atual = inicio;
+        while (ok) {
+            t->ops++;
+            const char* pista = pistaSala(&mapa, atual);
+            if (strcmp(sala->nome, nomeSala(&mapa, atual)) != 0
+                || strcmp(sala->pista, pista ? pista : "") != 0) {
+                ok = divergir(t, "caminho", sala->nome);
+                break;
+            }
+            int filhos = (sala->esquerda != NULL) + (sala->direita != NULL);
+            if (filhos != numSaidas(&mapa, atual)) {
+                ok = divergir(t, "caminho", "número de saídas diferente");
+                break;
+            }
+            // Lado vazio: 'e'/'d' do jogo deve recusar, sem cair na outra saída
+            if ((sala->esquerda == NULL && interpretarEscolha(&mapa, atual, "e") != ESCOLHA_SEM_ESQUERDA)
+                || (sala->direita == NULL && interpretarEscolha(&mapa, atual, "d") != ESCOLHA_SEM_DIREITA)) {
+                ok = divergir(t, "caminho", "lado vazio aceito");
+                break;
+            }
+            if (filhos == 0) break;
+            // A referência escolhe um lado da árvore; o jogo converte 'e'/'d' em saída do grafo
+            int direita = (filhos == 2) ? (int) (aleatorio(s) % 2) : (sala->direita != NULL);
+            sala = direita ? sala->direita : sala->esquerda;
+            int k = interpretarEscolha(&mapa, atual, direita ? "d" : "e");
+            if (k < 0 || k >= numSaidas(&mapa, atual)) {
+                ok = divergir(t, "caminho", direita ? "'d' sem saída" : "'e' sem saída");
+                break;
+            }
+            atual = mapa.destinos[mapa.inicio[atual] + k];
+        }
+    }
+
+    liberarMapa(&mapa);
+    liberarArvoreSalas(salas[0]);
+    return ok;
+}
+
+#define MAX_SALAS_GRAFO 1024
+#define MAX_GRAU 4
+
+// Referência: percurso em profundidade recursivo sobre o mesmo CSR
+static void refProfundidade(const MapaGrafo* m, int u, char* visto, int* ordem, int* total) {
+    visto[u] = 1;
+    ordem[(*total)++] = u;
+    for (int e = m->inicio[u]; e < m->inicio[u + 1]; e++) {
+        if (!visto[m->destinos[e]]) refProfundidade(m, m->destinos[e], visto, ordem, total);
+    }
+}
+
+// Referência: percurso em largura recursivo, um nível (fronteira) por chamada
+static int refLargura(const MapaGrafo* m, int* fronteira, int tam, int nivel, int* dist, int* proxima) {
+    if (tam == 0) return 0;
+    int tamProx = 0;
+    for (int i = 0; i < tam; i++) {
+        int u = fronteira[i];
+        for (int e = m->inicio[u]; e < m->inicio[u + 1]; e++) {
+            int v = m->destinos[e];
+            if (dist[v] < 0) {
+                dist[v] = nivel + 1;
+                proxima[tamProx++] = v;
+            }
+        }
+    }
+    // as duas filas trocam de papel a cada nível
+    return tam + refLargura(m, proxima, tamProx, nivel + 1, dist, fronteira);
+}
+
+static const char* PISTAS_GRAFO[] = {
+    "Pegadas de lama", "Lençol manchado", "Gaveta arrombada", "Chave perdida sob o tapete"
+};
+#define NUM_PISTAS_GRAFO ((int) (sizeof(PISTAS_GRAFO) / sizeof(PISTAS_GRAFO[0])))
+
+// Rodada de grafo: salas compartilhadas, ciclos, laços e saídas repetidas
+static int rodadaGrafo(Trabalho* t, unsigned int* s) {
+    static _Thread_local int origens[MAX_SALAS_GRAFO * MAX_GRAU];
+    static _Thread_local int destinos[MAX_SALAS_GRAFO * MAX_GRAU];
+    static _Thread_local int pos[MAX_SALAS_GRAFO];
+    static _Thread_local int ordem[MAX_SALAS_GRAFO];
+    static _Thread_local int ordemRef[MAX_SALAS_GRAFO];
+    static _Thread_local int dist[MAX_SALAS_GRAFO];
+    static _Thread_local int distRef[MAX_SALAS_GRAFO];
+    static _Thread_local int filaA[MAX_SALAS_GRAFO];
+    static _Thread_local int filaB[MAX_SALAS_GRAFO];
+    static _Thread_local char visto[MAX_SALAS_GRAFO];
+    static _Thread_local const char* emOrdemR[MAX_SALAS_GRAFO];
+    static _Thread_local const char* emOrdemN[MAX_SALAS_GRAFO];
+    char nome[50];
+
+    MapaGrafo mapa;
+    initMapa(&mapa);
+    int n = 1 + (int) (aleatorio(s) % MAX_SALAS_GRAFO);
+    for (int i = 0; i < n; i++) {
+        snprintf(nome, sizeof(nome), "Sala %d", i);
+        // pistas repetidas em salas diferentes geram duplicatas na BST
+        const char* pista = (aleatorio(s) % 3) ? PISTAS_GRAFO[aleatorio(s) % NUM_PISTAS_GRAFO] : NULL;
+        adicionarSalaMapa(&mapa, nome, pista);
+    }
+    // Conexões em ordem aleatória de origem, para testar o agrupamento estável
+    int numConexoes = (int) (aleatorio(s) % (unsigned int) (n * MAX_GRAU));
+    for (int e = 0; e < numConexoes; e++) {
+        origens[e]  = (int) (aleatorio(s) % (unsigned int) n);
+        destinos[e] = (aleatorio(s) % 4) ? (int) (aleatorio(s) % (unsigned int) n)
+                                         : (origens[e] + 1) % n; // corredor que fecha ciclo
+        conectarSalas(&mapa, origens[e], destinos[e]);
+    }
+    finalizarMapa(&mapa);
+    int ok = 1;
+
+    // CSR: saídas de cada sala na mesma ordem em que foram conectadas
+    for (int i = 0; i < n; i++) pos[i] = mapa.inicio[i];
+    for (int e = 0; e < numConexoes && ok; e++, t->ops++) {
+        if (mapa.destinos[pos[origens[e]]++] != destinos[e]) ok = divergir(t, "grafo", "ordem das saídas");
+    }
+    for (int i = 0; i < n && ok; i++) {
+        if (pos[i] != mapa.inicio[i + 1]) ok = divergir(t, "grafo", "número de saídas");
+    }
+
+    int origem = (int) (aleatorio(s) % (unsigned int) n);
+
+    // Profundidade
+    if (ok) {
+        int total = 0;
+        memset(visto, 0, (size_t) n);
+        refProfundidade(&mapa, origem, visto, ordemRef, &total);
+        int visitadas = buscaEmProfundidade(&mapa, origem, ordem);
+        if (visitadas != total) ok = divergir(t, "grafo-profundidade", "salas visitadas diferente");
+        for (int i = 0; i < total && ok; i++, t->ops++) {
+            if (ordem[i] != ordemRef[i]) ok = divergir(t, "grafo-profundidade", nomeSala(&mapa, ordem[i]));
+        }
+    }
+
+    // Largura
+    if (ok) {
+        for (int i = 0; i < n; i++) distRef[i] = -1;
+        distRef[origem] = 0;
+        filaA[0] = origem;
+        int totalRef = refLargura(&mapa, filaA, 1, 0, distRef, filaB);
+        int alcancadas = buscaEmLargura(&mapa, origem, dist);
+        if (alcancadas != totalRef) ok = divergir(t, "grafo-largura", "salas alcançáveis diferente");
+        for (int i = 0; i < n && ok; i++, t->ops++) {
+            if (dist[i] != distRef[i]) ok = divergir(t, "grafo-largura", nomeSala(&mapa, i));
+        }
+    }
+
+    // Caminho aleatório com revisitas: a pista de cada sala entra na BST uma única vez
+    if (ok) {
+        unsigned char* visitados = criarVisitados(mapa.numSalas);
+        PistaNode* pistas = NULL;
+        RefPistaNode* refPistas = NULL;
+        memset(visto, 0, (size_t) n);
+        int atual = origem;
+        for (int passo = 0; passo < 4 * n && ok; passo++, t->ops++) {
+            const char* pista = pistaSala(&mapa, atual);
+            int esperado = visto[atual] ? COLETA_JA_VISITADA : (pista ? COLETA_PISTA : COLETA_SEM_PISTA);
+            if (!visto[atual] && pista) refPistas = refInserirPista(refPistas, pista);
+            visto[atual] = 1;
+            if (coletarPistaDaSala(&mapa, atual, visitados, &pistas) != esperado) {
+                ok = divergir(t, "grafo-coleta", nomeSala(&mapa, atual));
+            }
+            int saidas = numSaidas(&mapa, atual);
+            if (saidas == 0) break;
+            atual = mapa.destinos[mapa.inicio[atual] + (int) (aleatorio(s) % (unsigned int) saidas)];
+        }
+        if (ok) {
+            int nRef = 0, nNova = 0;
+            emOrdemRef(refPistas, emOrdemR, &nRef);
+            emOrdemNova(pistas, emOrdemN, &nNova);
+            if (nRef != nNova) ok = divergir(t, "grafo-coleta", "quantidade de pistas diferente");
+            for (int i = 0; i < nRef && ok; i++) {
+                if (strcmp(emOrdemR[i], emOrdemN[i]) != 0) ok = divergir(t, "grafo-coleta", emOrdemR[i]);
+            }
+        }
+        free(visitados);
+        refLiberarPistas(refPistas);
+        liberarArvorePistas(pistas);
+    }
+
+    liberarMapa(&mapa);
+    return ok;
+}
+
+#define MAX_LONGAS 64
+#define TAM_LONGO 200
+
+static int compararTextos(const void* a, const void* b) {
+    return strcmp(*(const char* const*) a, *(const char* const*) b);
+}
+
+static int sinal(int x) {
+    return (x > 0) - (x < 0);
+}
+
+// Rodada de chaves longas: 100 a 127 bytes (caminho completo dos kernels) e acima de 127
+// (truncadas em TAM_CHAVE - 1), comparadas com strcmp/hashEscalar sobre o texto truncado
+static int rodadaChavesLongas(Trabalho* t, unsigned int* s) {
+    static _Thread_local char textos[MAX_LONGAS][TAM_LONGO + 1];
+    static _Thread_local char truncados[MAX_LONGAS][TAM_CHAVE];
+    static _Thread_local ChavePista chaves[MAX_LONGAS];
+    static _Thread_local const char* suspeitos[MAX_LONGAS];
+    static _Thread_local const char* ordemRef[MAX_LONGAS];
+    static _Thread_local const char* ordemNova[MAX_LONGAS];
+    int n = 2 + (int) (aleatorio(s) % (MAX_LONGAS - 1));
+    int ok = 1;
+
+    for (int i = 0; i < n && ok; i++, t->ops++) {
+        char* texto = textos[i];
+        unsigned int modo = aleatorio(s) % 4;
+        int tam;
+        if (i > 0 && modo < 2) {
+            // copia uma anterior e altera um byte perto do limite de truncamento
+            strcpy(texto, textos[aleatorio(s) % (unsigned int) i]);
+            tam = (int) strlen(texto);
+            if (tam > 0) {
+                int p = (modo == 0 && tam > TAM_CHAVE - 1)
+                        ? TAM_CHAVE - 1 + (int) (aleatorio(s) % (unsigned int) (tam - (TAM_CHAVE - 1)))  // só depois do corte: iguais
+                        : (int) (aleatorio(s) % (unsigned int) tam);
+                texto[p] = ALFABETO[aleatorio(s) % TAM_ALFABETO];
+            }
+        } else {
+            unsigned int faixa = aleatorio(s) % 3;
+            tam = (faixa == 0) ? 100 + (int) (aleatorio(s) % 28)                       // 100..127
+                : (faixa == 1) ? TAM_CHAVE + (int) (aleatorio(s) % (TAM_LONGO - TAM_CHAVE + 1)) // 128..200
+                :                (int) (aleatorio(s) % 100);                           // 0..99
+            for (int j = 0; j < tam; j++) texto[j] = ALFABETO[aleatorio(s) % TAM_ALFABETO];
+            texto[tam] = '\0';
+        }
+        snprintf(truncados[i], TAM_CHAVE, "%s", texto);
+        suspeitos[i] = SUSPEITOS[aleatorio(s) % NUM_SUSPEITOS];
+
+        criarChave(&chaves[i], texto);
+        if (chaves[i].tam != strlen(truncados[i]) || strcmp(chaves[i].texto, truncados[i]) != 0) {
+            ok = divergir(t, "chave-longa", "truncamento");
+        } else if (chaves[i].hash != hashEscalar(truncados[i])) {
+            ok = divergir(t, "chave-longa", "hash");
+        }
+    }
+
+    // Ordem e igualdade entre todos os pares
+    for (int i = 0; i < n && ok; i++) {
+        for (int j = 0; j < n && ok; j++, t->ops++) {
+            int esperado = strcmp(truncados[i], truncados[j]);
+            if (sinal(compararChaves(&chaves[i], &chaves[j])) != sinal(esperado)
+                || chavesIguais(&chaves[i], &chaves[j]) != (esperado == 0)) {
+                ok = divergir(t, "chave-longa", "comparação");
+            }
+        }
+    }
+
+    // Hash de suspeitos: vale a associação mais recente com o mesmo texto truncado
+    if (ok) {
+        HashSuspeitos hash;
+        initHash(&hash);
+        for (int i = 0; i < n; i++) inserirNaHash(&hash, textos[i], suspeitos[i]);
+        for (int j = 0; j < n && ok; j++, t->ops++) {
+            const char* esperado = NULL;
+            for (int i = n - 1; i >= 0 && esperado == NULL; i--) {
+                if (strcmp(truncados[i], truncados[j]) == 0) esperado = suspeitos[i];
+            }
+            const char* obtido = encontrarSuspeito(&hash, textos[j]);
+            if (obtido == NULL || strcmp(obtido, esperado) != 0) ok = divergir(t, "chave-longa", "busca");
+        }
+        liberarHash(&hash);
+    }
+
+    // BST: em-ordem igual aos textos truncados ordenados por strcmp
+    if (ok) {
+        PistaNode* pistas = NULL;
+        for (int i = 0; i < n; i++) {
+            pistas = inserirPista(pistas, textos[i]);
+            ordemRef[i] = truncados[i];
+        }
+        qsort(ordemRef, (size_t) n, sizeof(ordemRef[0]), compararTextos);
+        int nNova = 0;
+        emOrdemNova(pistas, ordemNova, &nNova);
+        if (nNova != n) ok = divergir(t, "chave-longa", "quantidade de pistas diferente");
+        for (int i = 0; i < n && ok; i++, t->ops++) {
+            if (strcmp(ordemRef[i], ordemNova[i]) != 0) ok = divergir(t, "chave-longa", "em-ordem");
+        }
+        liberarArvorePistas(pistas);
+    }
+    return ok;
+}
+
+static void* executarTrabalho(void* arg) {
+    Trabalho* t = (Trabalho*) arg;
+    unsigned int s = t->semente ? t->semente : 1;
+    while (t->ops < t->opsAlvo) {
+        int ok;
+        switch (aleatorio(&s) % 8) {
+            case 0:  ok = rodadaMapa(t, &s); break;
+            case 1:  ok = rodadaGrafo(t, &s); break;
+            case 2:  ok = rodadaChavesLongas(t, &s); break;
+            default: ok = rodadaPistas(t, &s); break;
+        }
+        if (!ok) break;
+        t->rodadas++;
+    }
+    return NULL;
+}
+
+static double agora(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    int numThreads = (argc > 1) ? atoi(argv[1]) : 4;
+    double milhoes = (argc > 2) ? atof(argv[2]) : 1.0;
+    unsigned int semente = (argc > 3) ? (unsigned int) strtoul(argv[3], NULL, 10) : (unsigned int) time(NULL);
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > MAX_THREADS) numThreads = MAX_THREADS;
+
+    static Trabalho trabalhos[MAX_THREADS];
+    static pthread_t threads[MAX_THREADS];
+
+    printf("=== Teste diferencial: %d thread(s), %.1f milhão(ões) de operações cada, semente %u ===\n",
+           numThreads, milhoes, semente);
+
+    double inicio = agora();
+    for (int i = 0; i < numThreads; i++) {
+        trabalhos[i].id = i;
+        trabalhos[i].semente = semente + (unsigned int) i;
+        trabalhos[i].opsAlvo = (long long) (milhoes * 1e6);
+        if (pthread_create(&threads[i], NULL, executarTrabalho, &trabalhos[i]) != 0) {
+            printf("Erro ao criar thread %d!\n", i);
+            exit(1);
+        }
+    }
+
+    long long totalOps = 0, totalRodadas = 0;
+    int falhas = 0;
+    for (int i = 0; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+        totalOps += trabalhos[i].ops;
+        totalRodadas += trabalhos[i].rodadas;
+        if (trabalhos[i].divergiu) {
+            printf("DIVERGÊNCIA: %s\n", trabalhos[i].mensagem);
+            falhas++;
+        }
+    }
+    double segundos = agora() - inicio;
+
+    printf("%lld operações em %lld rodadas, %.1f s (%.1f milhões de operações/s)\n",
+           totalOps, totalRodadas, segundos, segundos > 0 ? totalOps / segundos / 1e6 : 0.0);
+    if (falhas) {
+        printf("Resultado: %d thread(s) com divergência.\n", falhas);
+        return 1;
+    }
+    printf("Resultado: implementações equivalentes.\n");
+    return 0;
+}
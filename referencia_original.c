@@ -0,0 +1,110 @@
+/*
+Detective Quest - Implementação original de pistas e suspeitos (referência)
+Cópia do código anterior à ChavePista: BST de pistas com char[100] + strcmp e tabela hash
+de suspeitos com hash byte a byte. Usada como referência por diferencial_pistas.c (equivalência)
+e benchmark_pistas.c (tempo do fluxo completo).
+
+Não compila sozinho: inclua depois de detetiveQuest_final.c (usa TAM_HASH), assim:
+  #define DQ_SEM_MAIN
+  #include "detetiveQuest_final.c"
+  #include "referencia_original.c"
+*/
+
+#define TAM_TEXTO_REF 100 // tamanho dos campos de texto da implementação original
+
+typedef struct RefPistaNode {
+    char valor[TAM_TEXTO_REF];
+    struct RefPistaNode* esquerda;
+    struct RefPistaNode* direita;
+} RefPistaNode;
+
+typedef struct RefHashNode {
+    char chave[TAM_TEXTO_REF];
+    char valor[50];
+    struct RefHashNode* prox;
+} RefHashNode;
+
+typedef struct {
+    RefHashNode* buckets[TAM_HASH];
+} RefHashSuspeitos;
+
+static RefPistaNode* refInserirPista(RefPistaNode* raiz, const char* valor) {
+    if (raiz == NULL) {
+        RefPistaNode* novo = (RefPistaNode*) malloc(sizeof(RefPistaNode));
+        if (novo == NULL) {
+            printf("Erro ao alocar memória para a pista!\n");
+            exit(1);
+        }
+        strcpy(novo->valor, valor);
+        novo->esquerda = NULL;
+        novo->direita  = NULL;
+        return novo;
+    }
+    if (strcmp(valor, raiz->valor) < 0) {
+        raiz->esquerda = refInserirPista(raiz->esquerda, valor);
+    } else {
+        raiz->direita  = refInserirPista(raiz->direita,  valor);
+    }
+    return raiz;
+}
+
+static void refLiberarPistas(RefPistaNode* raiz) {
+    if (raiz != NULL) {
+        refLiberarPistas(raiz->esquerda);
+        refLiberarPistas(raiz->direita);
+        free(raiz);
+    }
+}
+
+static unsigned int refHashFunc(const char* s) {
+    unsigned int h = 0;
+    for (int i = 0; s[i] != '\0'; i++) {
+        h = (h * 131) + (unsigned char)s[i];
+    }
+    return h % TAM_HASH;
+}
+
+static void refInserirNaHash(RefHashSuspeitos* h, const char* pista, const char* suspeito) {
+    unsigned int idx = refHashFunc(pista);
+    RefHashNode* novo = (RefHashNode*) malloc(sizeof(RefHashNode));
+    if (!novo) {
+        printf("Erro ao alocar memória na hash!\n");
+        exit(1);
+    }
+    strcpy(novo->chave, pista);
+    strcpy(novo->valor, suspeito);
+    novo->prox = h->buckets[idx];
+    h->buckets[idx] = novo;
+}
+
+static const char* refEncontrarSuspeito(RefHashSuspeitos* h, const char* pista) {
+    unsigned int idx = refHashFunc(pista);
+    for (RefHashNode* no = h->buckets[idx]; no != NULL; no = no->prox) {
+        if (strcmp(no->chave, pista) == 0) {
+            return no->valor;
+        }
+    }
+    return NULL;
+}
+
+static void refLiberarHash(RefHashSuspeitos* h) {
+    for (int i = 0; i < TAM_HASH; i++) {
+        RefHashNode* no = h->buckets[i];
+        while (no) {
+            RefHashNode* nxt = no->prox;
+            free(no);
+            no = nxt;
+        }
+        h->buckets[i] = NULL;
+    }
+}
+
+static void refContarPistasDoSuspeito(RefPistaNode* raiz, RefHashSuspeitos* h, const char* acusado, int* contador) {
+    if (raiz == NULL) return;
+    refContarPistasDoSuspeito(raiz->esquerda, h, acusado, contador);
+    const char* s = refEncontrarSuspeito(h, raiz->valor);
+    if (s != NULL && strcmp(s, acusado) == 0) {
+        (*contador)++;
+    }
+    refContarPistasDoSuspeito(raiz->direita, h, acusado, contador);
+}